@@ -0,0 +1,97 @@
+#include "cfg/configuration.hpp"
+#include "cfg/helper/reflection.hpp"
+#include "cfg/parser.hpp"
+
+#include "cfg/format/json_nlohmann/json_nlohmann.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+OPTION(tenant)
+{
+    VALUE(std::string_view); // interned in the string pool of the batch
+    DESCRIPTION = "tenant name";
+};
+
+OPTION(region)
+{
+    VALUE(std::string) = "eu-west"; // copied into every configuration
+    DESCRIPTION = "tenant region";
+};
+
+OPTION(replicas)
+{
+    VALUE(int) = 1;
+    DESCRIPTION = "number of replicas";
+
+    static void validate(const decltype(value)& val)
+    {
+        if (val < 1)
+            throw std::runtime_error("there has to be at least 1 replica");
+    }
+};
+
+SECTION(service, tenant, region, replicas){};
+
+// parses the same set of tenant documents with 1, 8 and 64 threads and reports the best
+// documents/second out of a few runs each, usage: cfg_parse_batch_benchmark [document count]
+int main(int argc, char** argv)
+{
+    using config_t = cfg::configuration<service>;
+    using parser_t = cfg::parser<cfg::formats::json_nlohmann>;
+
+    const int document_count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (document_count < 1)
+    {
+        fmt::print(stderr, "the document count has to be at least 1\n");
+        return 1;
+    }
+
+    std::vector<std::string> documents;
+    documents.reserve(document_count);
+    for (int i = 0; i < document_count; ++i)
+        documents.push_back(fmt::format(
+            R"({{"service": {{"tenant": "tenant {}", "region": "eu-west", "replicas": {}}}}})",
+            i % 1000,
+            i % 5 + 1));
+
+    // untimed, so the first timed run doesn't pay for the allocator and page faults warming up
+    parser_t::parse_batch<config_t>(documents, 1);
+
+    constexpr int runs = 3;
+
+    for (std::size_t thread_count : {1, 8, 64})
+    {
+        double best_documents_per_second = 0;
+        std::size_t failed = 0;
+        std::size_t unique_strings = 0;
+
+        for (int run = 0; run < runs; ++run)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto result = parser_t::parse_batch<config_t>(documents, thread_count);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            best_documents_per_second =
+                std::max(best_documents_per_second, documents.size() / elapsed.count());
+
+            failed = std::count(result.configs.begin(), result.configs.end(), std::nullopt);
+            unique_strings = result.pool->size();
+        }
+
+        fmt::print("{:>2} threads: {:>10.0f} documents/second ({} failed, {} unique strings)\n",
+                   thread_count,
+                   best_documents_per_second,
+                   failed,
+                   unique_strings);
+    }
+}
@@ -9,6 +9,7 @@
 #include <fmt/core.h>
 #include <string>
 #include <tuple>
+#include <type_traits>
 
 namespace cfg
 {
@@ -176,4 +177,27 @@ namespace cfg
     private:
         sections_type _sections;
     };
+
+    template <class OPTIONS_T, class VALUE_T>
+    struct options_have_value_type;
+
+    template <class... OPTIONS, class VALUE_T>
+    struct options_have_value_type<std::tuple<OPTIONS...>, VALUE_T>
+        : std::disjunction<holds_type<value_t<OPTIONS>, VALUE_T>...>
+    { };
+
+    template <class SECTIONS_T, class VALUE_T>
+    struct sections_have_value_type;
+
+    template <class... SECTIONS, class VALUE_T>
+    struct sections_have_value_type<std::tuple<SECTIONS...>, VALUE_T>
+        : std::disjunction<options_have_value_type<typename SECTIONS::options_t, VALUE_T>...>
+    { };
+
+    // true if any option in any section of the configuration has a value that is or holds a
+    // VALUE_T (see holds_type)
+    template <class CONFIGURATION_T, class VALUE_T>
+    struct has_value_type
+        : sections_have_value_type<typename CONFIGURATION_T::sections_type, VALUE_T>
+    { };
 } // namespace cfg
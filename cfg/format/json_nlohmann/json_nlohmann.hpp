@@ -9,6 +9,10 @@
 
 #include "cfg/option.hpp"
 
+#include <string>
+#include <string_view>
+#include <type_traits>
+
 namespace cfg::formats
 {
     struct json_nlohmann
@@ -58,7 +62,20 @@ namespace cfg::formats
         {
             try
             {
-                return format_data[section_name][OPTION_TYPE::name].template get<RETURN_TYPE>();
+                const data_type& value = format_data[section_name][OPTION_TYPE::name];
+
+                // view into the json string, only valid as long as format_data is
+                if constexpr (std::is_same_v<RETURN_TYPE, std::string_view>)
+                {
+                    // same message as a std::string option gets from nlohmann
+                    if (!value.is_string())
+                        throw std::runtime_error{
+                            fmt::format("type must be string, but is {}", value.type_name())};
+
+                    return value.template get_ref<const std::string&>();
+                }
+                else
+                    return value.template get<RETURN_TYPE>();
             }
             catch (std::exception& e)
             {
@@ -5,7 +5,10 @@
 #pragma once
 
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <variant>
 
 namespace cfg
 {
@@ -64,6 +67,39 @@ namespace cfg
         : std::is_invocable_r<value_t<T>, decltype(&T::convert_from_string), std::string_view>
     { };
 
+    // true if T is VALUE_T, or holds one somewhere inside (containers, std::optional, std::pair,
+    // std::tuple, std::variant)
+    template <class T, class VALUE_T, typename = void>
+    struct holds_type : std::is_same<T, VALUE_T>
+    { };
+
+    // anything with a value_type, guarding against types that are their own value_type
+    template <class T, class VALUE_T>
+    struct holds_type<T, VALUE_T, std::void_t<typename T::value_type>>
+        : std::disjunction<std::is_same<T, VALUE_T>,
+                           std::conjunction<std::negation<std::is_same<typename T::value_type, T>>,
+                                            holds_type<typename T::value_type, VALUE_T>>>
+    { };
+
+    template <class FIRST, class SECOND, class VALUE_T>
+    struct holds_type<std::pair<FIRST, SECOND>, VALUE_T>
+        : std::disjunction<std::is_same<std::pair<FIRST, SECOND>, VALUE_T>,
+                           holds_type<std::remove_cv_t<FIRST>, VALUE_T>,
+                           holds_type<std::remove_cv_t<SECOND>, VALUE_T>>
+    { };
+
+    template <class... TYPES, class VALUE_T>
+    struct holds_type<std::tuple<TYPES...>, VALUE_T>
+        : std::disjunction<std::is_same<std::tuple<TYPES...>, VALUE_T>,
+                           holds_type<std::remove_cv_t<TYPES>, VALUE_T>...>
+    { };
+
+    template <class... TYPES, class VALUE_T>
+    struct holds_type<std::variant<TYPES...>, VALUE_T>
+        : std::disjunction<std::is_same<std::variant<TYPES...>, VALUE_T>,
+                           holds_type<std::remove_cv_t<TYPES>, VALUE_T>...>
+    { };
+
     template <typename T>
     struct has_const_iterator
     {
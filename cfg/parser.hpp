@@ -4,15 +4,40 @@
 
 #pragma once
 
+#include "cfg/configuration.hpp"
 #include "cfg/section.hpp"
+#include "cfg/string_pool.hpp"
 
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace cfg
 {
+    // output of parser::parse_batch, configs and errors are in the same order as the inputs. A
+    // document has either a config or a non-empty error string. The pool owns the strings that
+    // any std::string_view option values point to, so keep it alive alongside the configs
+    template <class CONFIGURATION_T>
+    struct batch_result
+    {
+        std::vector<std::optional<CONFIGURATION_T>> configs;
+        std::vector<std::string> errors;
+        std::shared_ptr<string_pool> pool;
+    };
+
     template <class FORMAT>
     struct parser
     {
@@ -26,15 +51,187 @@ namespace cfg
     public:
         template <class CONFIGURATION_T, class INPUT_DATA_T>
         static CONFIGURATION_T parse(const INPUT_DATA_T& input_data)
+        {
+            static_assert(!has_value_type<CONFIGURATION_T, std::string_view>::value,
+                          "std::string_view options need a string_pool to point into, use "
+                          "parse(input_data, pool) or parse_batch (only a top-level "
+                          "std::string_view value can be pooled)");
+
+            return parse_document<CONFIGURATION_T>(input_data, nullptr);
+        }
+
+        // same as above, but std::string_view option values are interned in the pool, which has
+        // to outlive the returned configuration
+        template <class CONFIGURATION_T, class INPUT_DATA_T>
+        static CONFIGURATION_T parse(const INPUT_DATA_T& input_data, string_pool& pool)
+        {
+            return parse_document<CONFIGURATION_T>(input_data, &pool);
+        }
+
+        // parse many documents of the same configuration type, splitting them over thread_count
+        // threads. std::string_view option values are interned in the (possibly shared) string
+        // pool, std::string values are still copied into each configuration. A document that
+        // fails doesn't stop the batch, its errors are stored at the same index.
+        //
+        // There is no schema to share between documents: the per-option parsing code is generated
+        // from the configuration type at compile time, what is left per document is the lookups
+        // in that document's own format data
+        template <class CONFIGURATION_T, class INPUT_RANGE_T>
+        static batch_result<CONFIGURATION_T> parse_batch(
+            const INPUT_RANGE_T& inputs,
+            std::size_t thread_count = std::thread::hardware_concurrency(),
+            std::shared_ptr<string_pool> pool = std::make_shared<string_pool>())
+        {
+            using input_iterator_t = decltype(std::begin(inputs));
+            static_assert(
+                std::is_base_of_v<std::random_access_iterator_tag,
+                                  typename std::iterator_traits<input_iterator_t>::iterator_category>,
+                "parse_batch needs a random access range of inputs (e.g. std::vector)");
+
+            const std::size_t input_count = std::size(inputs);
+
+            batch_result<CONFIGURATION_T> result;
+            result.configs.resize(input_count);
+            result.errors.resize(input_count);
+            result.pool = std::move(pool);
+
+            std::atomic<std::size_t> next_input{0};
+
+            // anything that escapes a document (e.g. out of memory while storing its result)
+            // stops the batch and is rethrown once every worker has finished
+            std::mutex worker_failure_mutex;
+            std::exception_ptr worker_failure;
+
+            auto worker = [&inputs,
+                           &input_count,
+                           &next_input,
+                           &result,
+                           &worker_failure_mutex,
+                           &worker_failure]() {
+                try
+                {
+                    for (std::size_t i = next_input++; i < input_count; i = next_input++)
+                    {
+                        std::string errors;
+                        CONFIGURATION_T config;
+
+                        try
+                        {
+                            format_data_t format_data =
+                                FORMAT::parse(std::begin(inputs)[i]);
+                            parse_into(format_data, config, errors);
+
+                            // only once the whole document passed, so rejected values don't
+                            // stay in the pool
+                            if (errors.empty())
+                                intern_views(config, *result.pool);
+                        }
+                        catch (std::exception& ex)
+                        {
+                            errors += fmt::format("> document parse failure with error: {}\n",
+                                                  ex.what());
+                        }
+                        catch (...)
+                        {
+                            errors += "> document parse failure with unknown error\n";
+                        }
+
+                        if (errors.empty())
+                            result.configs[i] = std::move(config);
+                        else
+                            result.errors[i] = std::move(errors);
+                    }
+                }
+                catch (...)
+                {
+                    std::lock_guard lock{worker_failure_mutex};
+                    if (!worker_failure)
+                        worker_failure = std::current_exception();
+                    next_input = input_count;
+                }
+            };
+
+            // no point starting more threads than there are documents
+            thread_count =
+                std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(input_count, 1));
+            if (thread_count == 1)
+            {
+                worker();
+            }
+            else
+            {
+                // joins on destruction, so if starting one of the threads throws then the ones
+                // already running finish before the locals they reference go out of scope
+                struct thread_joiner
+                {
+                    std::vector<std::thread> threads;
+
+                    ~thread_joiner()
+                    {
+                        for (auto& thread : threads)
+                            thread.join();
+                    }
+                };
+
+                thread_joiner joiner;
+                auto& threads = joiner.threads;
+                threads.reserve(thread_count);
+                for (std::size_t i = 0; i < thread_count; ++i)
+                    threads.emplace_back(worker);
+            }
+
+            if (worker_failure)
+                std::rethrow_exception(worker_failure);
+
+            return result;
+        }
+
+        template <class CONFIGURATION>
+        static std::string generate_example_config(const CONFIGURATION& config = CONFIGURATION{})
+        {
+            format_data_t format_data;
+
+            config.for_each([&config, &format_data](const auto& section_obj,
+                                                    const auto& option_obj) {
+                // get the type of the option_obj
+                using option_type = std::remove_reference_t<decltype(option_obj)>;
+                using section_type = std::remove_reference_t<decltype(section_obj)>;
+
+                // TODO: allow convert to string on UD types
+                FORMAT::add(format_data, section_type::name, option_type::name, option_obj.value);
+            });
+
+            return FORMAT::string(format_data);
+        }
+
+    private:
+        template <class CONFIGURATION_T, class INPUT_DATA_T>
+        static CONFIGURATION_T parse_document(const INPUT_DATA_T& input_data, string_pool* pool)
         {
             format_data_t format_data = FORMAT::parse(input_data);
             CONFIGURATION_T returned_config; // initially empty
 
             std::string errors;
+            parse_into(format_data, returned_config, errors);
+
+            if (!errors.empty())
+                throw std::runtime_error(fmt::format("\n{}", errors));
+
+            if (pool != nullptr)
+                intern_views(returned_config, *pool);
 
-            returned_config.for_each([&errors,
-                                      &format_data,
-                                      &returned_config](const auto& section_obj, auto& option_obj) {
+            return returned_config;
+        }
+
+        // fill config from the already parsed format data, appending any failures to errors.
+        // std::string_view values still point into format_data afterwards, see intern_views
+        template <class CONFIGURATION_T>
+        static void parse_into(format_data_t& format_data,
+                               CONFIGURATION_T& returned_config,
+                               std::string& errors)
+        {
+            returned_config.for_each([&errors, &format_data](const auto& section_obj,
+                                                             auto& option_obj) {
                 // get the type of the option_obj
                 using option_type = std::remove_reference_t<decltype(option_obj)>;
                 using section_type = std::remove_reference_t<decltype(section_obj)>;
@@ -49,11 +246,27 @@ namespace cfg
                     return;
                 }
 
+                // only a top-level view is interned, a view inside e.g. a container would point
+                // into the format data after it is gone
+                static_assert(std::is_same_v<value_t<option_type>, std::string_view> ||
+                                  !holds_type<value_t<option_type>, std::string_view>::value,
+                              "only a top-level std::string_view option value can be pooled");
+
                 value_t<option_type> parsed_option_value;
                 try
                 {
-                    // TODO: add ability to parse UD types
-                    parsed_option_value = FORMAT::get(format_data, section_type::name, option_obj);
+                    // a view into the format data, until intern_views moves it into the pool
+                    if constexpr (std::is_same_v<value_t<option_type>, std::string_view>)
+                    {
+                        parsed_option_value = FORMAT::template get<option_type, std::string_view>(
+                            format_data, section_type::name, option_obj);
+                    }
+                    else
+                    {
+                        // TODO: add ability to parse UD types
+                        parsed_option_value =
+                            FORMAT::get(format_data, section_type::name, option_obj);
+                    }
                 }
                 catch (std::exception& ex)
                 {
@@ -83,29 +296,19 @@ namespace cfg
                 // and if all these pass, then move the parsed value into the option value field
                 option_obj.value = std::move(parsed_option_value);
             });
-
-            if (!errors.empty())
-                throw std::runtime_error(fmt::format("\n{}", errors));
-
-            return returned_config;
         }
 
-        template <class CONFIGURATION>
-        static std::string generate_example_config(const CONFIGURATION& config = CONFIGURATION{})
+        // point the std::string_view values of a successfully parsed config into the pool, so they
+        // outlive the format data they were read from
+        template <class CONFIGURATION_T>
+        static void intern_views(CONFIGURATION_T& config, string_pool& pool)
         {
-            format_data_t format_data;
-
-            config.for_each([&config, &format_data](const auto& section_obj,
-                                                    const auto& option_obj) {
-                // get the type of the option_obj
+            config.for_each([&pool](const auto&, auto& option_obj) {
                 using option_type = std::remove_reference_t<decltype(option_obj)>;
-                using section_type = std::remove_reference_t<decltype(section_obj)>;
 
-                // TODO: allow convert to string on UD types
-                FORMAT::add(format_data, section_type::name, option_type::name, option_obj.value);
+                if constexpr (std::is_same_v<value_t<option_type>, std::string_view>)
+                    option_obj.value = pool.intern(option_obj.value);
             });
-
-            return FORMAT::string(format_data);
         }
     };
 } // namespace cfg
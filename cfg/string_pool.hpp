@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace cfg
+{
+    // thread safe pool of unique strings, options with a std::string_view value point into this
+    // when parsed with parser::parse_batch (or parse with a pool), so identical values across
+    // documents are only stored once. The views stay valid for as long as the pool is alive.
+    //
+    // Values are only interned once their whole document parsed and validated. The pool never
+    // drops a string though, if it is passed from one batch to the next it grows with every
+    // distinct accepted value, so for repeated syncs start each one with a new pool; the results
+    // of earlier batches keep their own pool alive through batch_result::pool
+    class string_pool
+    {
+    public:
+        string_pool() = default;
+        string_pool(const string_pool&) = delete;
+        string_pool& operator=(const string_pool&) = delete;
+
+    public:
+        std::string_view intern(std::string_view value)
+        {
+            shard& value_shard = _shards[std::hash<std::string_view>{}(value) % shard_count];
+
+            {
+                std::shared_lock lock{value_shard.mutex};
+                if (auto found = value_shard.views.find(value); found != value_shard.views.end())
+                    return *found;
+            }
+
+            std::unique_lock lock{value_shard.mutex};
+            // another thread may have added it between the two locks
+            if (auto found = value_shard.views.find(value); found != value_shard.views.end())
+                return *found;
+
+            return *value_shard.views.insert(value_shard.strings.emplace_back(value)).first;
+        }
+
+        std::size_t size() const
+        {
+            std::size_t total = 0;
+            for (const auto& pool_shard : _shards)
+            {
+                std::shared_lock lock{pool_shard.mutex};
+                total += pool_shard.views.size();
+            }
+            return total;
+        }
+
+    private:
+        // split over several locks so parallel parsers don't all contend on the same one, each
+        // on its own cache line. The set holds views into the strings, so lookups don't need to
+        // build a std::string first (the deque doesn't move its elements when growing)
+        struct alignas(64) shard
+        {
+            mutable std::shared_mutex mutex;
+            std::unordered_set<std::string_view> views;
+            std::deque<std::string> strings;
+        };
+
+        static constexpr std::size_t shard_count = 16;
+
+    private:
+        std::array<shard, shard_count> _shards;
+    };
+} // namespace cfg